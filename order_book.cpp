@@ -8,8 +8,8 @@ public:
     string username;
     int balance;
     map<string, int> stocksOwned; // Company name -> Number of stocks owned
-    map<string, vector<pair<int, int>>> buyOrders;  // Company name -> List of (price, quantity) buy orders
-    map<string, vector<pair<int, int>>> sellOrders; // Company name -> List of (price, quantity) sell orders
+    map<string, map<int, pair<int, int>>> buyOrders;  // Company name -> Order id -> (price, remaining quantity) of resting buy orders
+    map<string, map<int, pair<int, int>>> sellOrders; // Company name -> Order id -> (price, remaining quantity) of resting sell orders
 
     UserProfile() : username(""), balance(0) {}  // Default constructor
 
@@ -27,27 +27,27 @@ public:
         for (const auto& order : buyOrders) {
             cout << "  " << order.first << ":" << endl;
             for (const auto& p : order.second) {
-                cout << "    Price: " << p.first << ", Quantity: " << p.second << endl;
+                cout << "    Order " << p.first << ": Price: " << p.second.first << ", Quantity: " << p.second.second << endl;
             }
         }
         cout << "Sell Orders:" << endl;
         for (const auto& order : sellOrders) {
             cout << "  " << order.first << ":" << endl;
             for (const auto& p : order.second) {
-                cout << "    Price: " << p.first << ", Quantity: " << p.second << endl;
+                cout << "    Order " << p.first << ": Price: " << p.second.first << ", Quantity: " << p.second.second << endl;
             }
         }
         cout << endl;
     }
 
     // Function to add buy order
-    void addBuyOrder(const string& stockName, int price, int quantity) {
-        buyOrders[stockName].push_back(make_pair(price, quantity));
+    void addBuyOrder(const string& stockName, int orderId, int price, int quantity) {
+        buyOrders[stockName][orderId] = make_pair(price, quantity);
     }
 
     // Function to add sell order
-    void addSellOrder(const string& stockName, int price, int quantity) {
-        sellOrders[stockName].push_back(make_pair(price, quantity));
+    void addSellOrder(const string& stockName, int orderId, int price, int quantity) {
+        sellOrders[stockName][orderId] = make_pair(price, quantity);
     }
 
     // Function to update stocks owned after a trade
@@ -58,66 +58,336 @@ public:
         }
     }
 
-    // Function to remove a completed order
-    void removeCompletedOrder(map<string, vector<pair<int, int>>>& orders, const string& stockName, int price, int quantity) {
-        auto& orderList = orders[stockName];
-        for (auto it = orderList.begin(); it != orderList.end(); ++it) {
-            if (it->first == price && it->second == quantity) {
-                orderList.erase(it);
-                break;
+    // Function to take filled or cancelled quantity off a resting order, removing it once nothing is left
+    void reduceOrder(map<string, map<int, pair<int, int>>>& orders, const string& stockName, int orderId, int quantity) {
+        auto stock = orders.find(stockName);
+        if (stock == orders.end()) return;
+        auto order = stock->second.find(orderId);
+        if (order == stock->second.end()) return;
+        order->second.second -= quantity;
+        if (order->second.second <= 0) {
+            stock->second.erase(order);
+        }
+        if (stock->second.empty()) {
+            orders.erase(stock);
+        }
+    }
+};
+
+// Single buy, sell or cancel entry of a batch submission
+struct BatchOrder {
+    enum Type { BUY, SELL, CANCEL };
+    Type type;
+    string stockName;
+    int price;
+    int quantity;
+    UserProfile* user;
+    int orderId; // Order to cancel (CANCEL only)
+};
+
+// Outcome of one batch entry, written to the slot with the same index as the order
+struct BatchResult {
+    enum Status { OK, STOCK_NOT_FOUND, ORDER_NOT_FOUND };
+    Status status;
+    int filledQuantity;  // Quantity traded (buy/sell) or removed from the book (cancel)
+    int restingQuantity; // Quantity of the order left resting on the book
+    int orderId;         // Id assigned to a buy/sell, usable for a later cancel
+};
+
+// Class to keep a live mark-to-market valuation of every account that has traded.
+// A fill only touches the two accounts on either side of it, and a price change only touches
+// the holders of that stock, so nothing ever rescans all users or all stocks.
+class PortfolioValuation {
+    struct Account {
+        UserProfile* user;
+        int initialBalance;
+        int cash;
+        long long netExposure;   // Sum of position * price over all stocks
+        long long grossExposure; // Sum of |position| * price over all stocks
+        unsigned version;        // Bumped on every change so stale heap entries can be skipped
+    };
+
+    map<UserProfile*, Account> accounts;
+    map<string, int> prices;                    // Stock -> price used for valuation
+    map<string, map<Account*, int>> holders;    // Stock -> accounts with a non-zero position -> position
+    priority_queue<tuple<long long, unsigned, Account*>> exposureHeap; // (gross exposure, version, account)
+    long long firmNet = 0;
+    long long firmGross = 0;
+    long long firmPnl = 0;
+
+    // Applies a change to one account and the firm totals, and refreshes its heap entry
+    void update(Account& account, long long netChange, long long grossChange, int cashChange) {
+        account.cash += cashChange;
+        account.netExposure += netChange;
+        account.grossExposure += grossChange;
+        firmNet += netChange;
+        firmGross += grossChange;
+        firmPnl += netChange + cashChange;
+        ++account.version;
+        exposureHeap.push(make_tuple(account.grossExposure, account.version, &account));
+        // Drop stale entries once they outnumber live ones so the heap stays proportional to the accounts
+        if (exposureHeap.size() > 2 * accounts.size() + 64) {
+            exposureHeap = priority_queue<tuple<long long, unsigned, Account*>>();
+            for (auto& entry : accounts) {
+                exposureHeap.push(make_tuple(entry.second.grossExposure, entry.second.version, &entry.second));
             }
         }
-        if (orderList.empty()) {
-            orders.erase(stockName);
+    }
+
+public:
+    // Function to record a user's net fill on a stock after their balance and holdings were updated
+    void onFill(UserProfile& user, const string& stockName, int quantity, int cashChange) {
+        auto found = accounts.find(&user);
+        if (found == accounts.end()) {
+            int startingBalance = user.balance - cashChange;
+            found = accounts.emplace(&user, Account{&user, startingBalance, startingBalance, 0, 0, 0}).first;
+        }
+        Account& account = found->second;
+        long long price = prices[stockName];
+        map<Account*, int>& stockHolders = holders[stockName];
+        auto holding = stockHolders.find(&account);
+        int before = holding == stockHolders.end() ? 0 : holding->second;
+        int after = before + quantity;
+        if (after == 0) {
+            if (holding != stockHolders.end()) stockHolders.erase(holding);
+        } else {
+            stockHolders[&account] = after;
+        }
+        update(account, (after - before) * price, (long long)(abs(after) - abs(before)) * price, cashChange);
+    }
+
+    // Function to revalue the holders of a stock after its last traded price changed
+    void onPrice(const string& stockName, int price) {
+        int& current = prices[stockName];
+        long long change = price - current;
+        if (change == 0) return;
+        current = price;
+        for (auto& holding : holders[stockName]) {
+            update(*holding.first, holding.second * change, abs(holding.second) * change, 0);
         }
     }
+
+    // Function to get the n accounts with the largest gross exposure, largest first
+    vector<pair<long long, UserProfile*>> topExposures(size_t n) {
+        vector<pair<long long, UserProfile*>> top;
+        vector<tuple<long long, unsigned, Account*>> live;
+        while (!exposureHeap.empty() && live.size() < n) {
+            auto entry = exposureHeap.top();
+            exposureHeap.pop();
+            if (get<1>(entry) != get<2>(entry)->version) continue;
+            live.push_back(entry);
+            top.push_back(make_pair(get<0>(entry), get<2>(entry)->user));
+        }
+        for (const auto& entry : live) {
+            exposureHeap.push(entry);
+        }
+        return top;
+    }
+
+    // Mark-to-market P&L of one account: cash plus position value minus its balance before its first fill
+    long long getPnl(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        if (found == accounts.end()) return 0;
+        return found->second.cash + found->second.netExposure - found->second.initialBalance;
+    }
+
+    long long getNetExposure(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        return found == accounts.end() ? 0 : found->second.netExposure;
+    }
+
+    long long getGrossExposure(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        return found == accounts.end() ? 0 : found->second.grossExposure;
+    }
+
+    long long getFirmPnl() const { return firmPnl; }
+    long long getFirmNetExposure() const { return firmNet; }
+    long long getFirmGrossExposure() const { return firmGross; }
 };
 
 // Class to manage the order book for a single stock
 class OrderBook {
-    map<int, int> buy;  // price -> quantity
-    map<int, int> sell; // price -> quantity
+    // An order waiting on the book, in time priority within its price level
+    struct RestingOrder {
+        int id;
+        UserProfile* owner;
+        int quantity; // Quantity still unfilled
+    };
+
+    // Where a resting order lives, so it can be cancelled without scanning the book
+    struct OrderLocation {
+        bool isBuy;
+        int price;
+        list<RestingOrder>::iterator entry;
+    };
+
+    map<int, list<RestingOrder>> buy;  // price -> resting buy orders
+    map<int, list<RestingOrder>> sell; // price -> resting sell orders
+    map<int, OrderLocation> ordersById;
+    int nextOrderId;
     int ltp; // last traded price
+    PortfolioValuation* valuation; // Notified of fills and price changes, if set
 
-public:
-    OrderBook() : ltp(0) {}
-
-    // Function to place a buy order
-    void buyOrder(int price, int quantity, UserProfile& user, const string& stockName) {
-        user.addBuyOrder(stockName, price, quantity);
+    // Matches an incoming buy against resting sells and rests what is left under orderId.
+    // Returns the filled quantity; balance and stocks changes for both sides of each trade are added to deltas.
+    int matchBuy(int orderId, int price, int& quantity, UserProfile& user, const string& stockName,
+                 map<UserProfile*, pair<int, int>>& deltas) {
+        int filled = 0;
         while (quantity > 0 && !sell.empty() && sell.begin()->first <= price) {
-            auto bestSell = sell.begin();
-            int tradeQuantity = min(quantity, bestSell->second);
-            ltp = bestSell->first;
+            auto level = sell.begin();
+            RestingOrder& bestSell = level->second.front();
+            int tradeQuantity = min(quantity, bestSell.quantity);
+            ltp = level->first;
             quantity -= tradeQuantity;
-            user.balance -= ltp * tradeQuantity;
-            user.updateStocksOwned(stockName, tradeQuantity);
-            bestSell->second -= tradeQuantity;
-            if (bestSell->second == 0) sell.erase(bestSell);
-            user.removeCompletedOrder(user.sellOrders, stockName, ltp, tradeQuantity);
+            filled += tradeQuantity;
+            deltas[&user].first -= ltp * tradeQuantity;
+            deltas[&user].second += tradeQuantity;
+            deltas[bestSell.owner].first += ltp * tradeQuantity;
+            deltas[bestSell.owner].second -= tradeQuantity;
+            bestSell.quantity -= tradeQuantity;
+            bestSell.owner->reduceOrder(bestSell.owner->sellOrders, stockName, bestSell.id, tradeQuantity);
+            if (bestSell.quantity == 0) {
+                ordersById.erase(bestSell.id);
+                level->second.pop_front();
+                if (level->second.empty()) sell.erase(level);
+            }
         }
         if (quantity > 0) {
-            buy[price] += quantity;
+            auto& orders = buy[price];
+            orders.push_back({orderId, &user, quantity});
+            ordersById[orderId] = {true, price, prev(orders.end())};
+            user.addBuyOrder(stockName, orderId, price, quantity);
         }
+        return filled;
     }
 
-    // Function to place a sell order
-    void sellOrder(int price, int quantity, UserProfile& user, const string& stockName) {
-        user.addSellOrder(stockName, price, quantity);
+    // Matches an incoming sell against resting buys and rests what is left under orderId.
+    // Returns the filled quantity; balance and stocks changes for both sides of each trade are added to deltas.
+    int matchSell(int orderId, int price, int& quantity, UserProfile& user, const string& stockName,
+                  map<UserProfile*, pair<int, int>>& deltas) {
+        int filled = 0;
         while (quantity > 0 && !buy.empty() && buy.rbegin()->first >= price) {
-            auto bestBuy = --buy.end();
-            int tradeQuantity = min(quantity, bestBuy->second);
-            ltp = bestBuy->first;
+            auto level = --buy.end();
+            RestingOrder& bestBuy = level->second.front();
+            int tradeQuantity = min(quantity, bestBuy.quantity);
+            ltp = level->first;
             quantity -= tradeQuantity;
-            user.balance += ltp * tradeQuantity;
-            user.updateStocksOwned(stockName, -tradeQuantity);
-            bestBuy->second -= tradeQuantity;
-            if (bestBuy->second == 0) buy.erase(bestBuy);
-            user.removeCompletedOrder(user.buyOrders, stockName, ltp, tradeQuantity);
+            filled += tradeQuantity;
+            deltas[&user].first += ltp * tradeQuantity;
+            deltas[&user].second -= tradeQuantity;
+            deltas[bestBuy.owner].first -= ltp * tradeQuantity;
+            deltas[bestBuy.owner].second += tradeQuantity;
+            bestBuy.quantity -= tradeQuantity;
+            bestBuy.owner->reduceOrder(bestBuy.owner->buyOrders, stockName, bestBuy.id, tradeQuantity);
+            if (bestBuy.quantity == 0) {
+                ordersById.erase(bestBuy.id);
+                level->second.pop_front();
+                if (level->second.empty()) buy.erase(level);
+            }
         }
         if (quantity > 0) {
-            sell[price] += quantity;
+            auto& orders = sell[price];
+            orders.push_back({orderId, &user, quantity});
+            ordersById[orderId] = {false, price, prev(orders.end())};
+            user.addSellOrder(stockName, orderId, price, quantity);
+        }
+        return filled;
+    }
+
+    // Removes the user's resting order with the given id; returns false if it is not on the book or not theirs.
+    bool removeOrder(int orderId, UserProfile& user, const string& stockName, int& cancelled) {
+        auto found = ordersById.find(orderId);
+        if (found == ordersById.end() || found->second.entry->owner != &user) {
+            return false;
+        }
+        OrderLocation location = found->second;
+        map<int, list<RestingOrder>>& side = location.isBuy ? buy : sell;
+        cancelled = location.entry->quantity;
+        user.reduceOrder(location.isBuy ? user.buyOrders : user.sellOrders, stockName, orderId, cancelled);
+        auto level = side.find(location.price);
+        level->second.erase(location.entry);
+        if (level->second.empty()) side.erase(level);
+        ordersById.erase(found);
+        return true;
+    }
+
+    // Applies the netted balance and stocks changes of one or more orders and reports them for valuation.
+    void settle(const map<UserProfile*, pair<int, int>>& deltas, const string& stockName) {
+        for (const auto& delta : deltas) {
+            delta.first->balance += delta.second.first;
+            delta.first->updateStocksOwned(stockName, delta.second.second);
+            if (valuation) valuation->onFill(*delta.first, stockName, delta.second.second, delta.second.first);
+        }
+        if (valuation && !deltas.empty()) {
+            valuation->onPrice(stockName, ltp);
+        }
+    }
+
+    // Total quantity resting at one price level
+    static int levelQuantity(const list<RestingOrder>& orders) {
+        int total = 0;
+        for (const auto& order : orders) total += order.quantity;
+        return total;
+    }
+
+public:
+    OrderBook(PortfolioValuation* valuation = nullptr) : nextOrderId(1), ltp(0), valuation(valuation) {}
+
+    // Function to place a buy order; returns the id of the order
+    int buyOrder(int price, int quantity, UserProfile& user, const string& stockName) {
+        int orderId = nextOrderId++;
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        matchBuy(orderId, price, quantity, user, stockName, deltas);
+        settle(deltas, stockName);
+        return orderId;
+    }
+
+    // Function to place a sell order; returns the id of the order
+    int sellOrder(int price, int quantity, UserProfile& user, const string& stockName) {
+        int orderId = nextOrderId++;
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        matchSell(orderId, price, quantity, user, stockName, deltas);
+        settle(deltas, stockName);
+        return orderId;
+    }
+
+    // Function to cancel one of the user's resting orders; cancelled is set to the quantity removed from the book
+    bool cancelOrder(int orderId, UserProfile& user, const string& stockName, int& cancelled) {
+        return removeOrder(orderId, user, stockName, cancelled);
+    }
+
+    // Function to apply the entries of a batch that target this stock, in submission order.
+    // Balance and holdings changes are netted per user and applied once at the end of the batch.
+    void applyBatch(const vector<BatchOrder>& orders, const vector<size_t>& indices, vector<BatchResult>& results,
+                    const string& stockName) {
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        for (size_t index : indices) {
+            const BatchOrder& order = orders[index];
+            UserProfile& user = *order.user;
+            BatchResult& result = results[index];
+            int quantity = order.quantity;
+            result = {BatchResult::OK, 0, 0, 0};
+            switch (order.type) {
+            case BatchOrder::BUY:
+                result.orderId = nextOrderId++;
+                result.filledQuantity = matchBuy(result.orderId, order.price, quantity, user, stockName, deltas);
+                result.restingQuantity = quantity;
+                break;
+            case BatchOrder::SELL:
+                result.orderId = nextOrderId++;
+                result.filledQuantity = matchSell(result.orderId, order.price, quantity, user, stockName, deltas);
+                result.restingQuantity = quantity;
+                break;
+            case BatchOrder::CANCEL:
+                result.orderId = order.orderId;
+                if (!removeOrder(order.orderId, user, stockName, result.filledQuantity)) {
+                    result.status = BatchResult::ORDER_NOT_FOUND;
+                }
+                break;
+            }
         }
+        settle(deltas, stockName);
     }
 
     // Function to display the current state of the order book
@@ -127,7 +397,7 @@ public:
         cout << "|      Price      |      Quantity      |" << endl;
         cout << "----------------------------------------" << endl;
         for (auto it = buy.rbegin(); it != buy.rend(); ++it) {
-            cout << "|   " << setw(7) << it->first << "   |   " << setw(9) << it->second << "   |" << endl;
+            cout << "|   " << setw(7) << it->first << "   |   " << setw(9) << levelQuantity(it->second) << "   |" << endl;
         }
         cout << "----------------------------------------" << endl;
 
@@ -135,8 +405,8 @@ public:
         cout << "----------------------------------------" << endl;
         cout << "|      Price      |      Quantity      |" << endl;
         cout << "----------------------------------------" << endl;
-        for (auto it : sell) {
-            cout << "|      " << setw(7) << it.first << "      |      " << setw(9) << it.second << "      |" << endl;
+        for (const auto& it : sell) {
+            cout << "|      " << setw(7) << it.first << "      |      " << setw(9) << levelQuantity(it.second) << "      |" << endl;
         }
         cout << "----------------------------------------" << endl;
 
@@ -151,6 +421,7 @@ public:
 // Class to manage all stocks and their respective order books
 class StockMarket {
     map<string, OrderBook> stocks;
+    PortfolioValuation valuation;
 
 public:
     // Function to list a new stock in the market
@@ -158,27 +429,66 @@ public:
         if (stocks.find(stockName) != stocks.end()) {
             cout << "Stock already listed in the market." << endl;
         } else {
-            stocks[stockName] = OrderBook();
+            stocks[stockName] = OrderBook(&valuation);
             cout << "Stock " << stockName << " listed successfully!" << endl;
         }
     }
 
-    // Function to place a buy order for a specific stock
-    void buyOrder(const string& stockName, int price, int quantity, UserProfile& user) {
+    // Function to place a buy order for a specific stock; returns the order id, or -1 if the stock is not listed
+    int buyOrder(const string& stockName, int price, int quantity, UserProfile& user) {
         if (stocks.find(stockName) == stocks.end()) {
             cout << "Stock not found in the market." << endl;
-            return;
+            return -1;
         }
-        stocks[stockName].buyOrder(price, quantity, user, stockName);
+        return stocks[stockName].buyOrder(price, quantity, user, stockName);
     }
 
-    // Function to place a sell order for a specific stock
-    void sellOrder(const string& stockName, int price, int quantity, UserProfile& user) {
+    // Function to place a sell order for a specific stock; returns the order id, or -1 if the stock is not listed
+    int sellOrder(const string& stockName, int price, int quantity, UserProfile& user) {
         if (stocks.find(stockName) == stocks.end()) {
             cout << "Stock not found in the market." << endl;
-            return;
+            return -1;
+        }
+        return stocks[stockName].sellOrder(price, quantity, user, stockName);
+    }
+
+    // Function to cancel one of the user's resting orders for a specific stock; returns the quantity removed
+    int cancelOrder(const string& stockName, int orderId, UserProfile& user) {
+        if (stocks.find(stockName) == stocks.end()) {
+            cout << "Stock not found in the market." << endl;
+            return 0;
+        }
+        int cancelled = 0;
+        if (!stocks[stockName].cancelOrder(orderId, user, stockName, cancelled)) {
+            cout << "Order not found." << endl;
+        }
+        return cancelled;
+    }
+
+    // Function to submit a burst of orders and cancels at once. Entries are grouped by stock so each
+    // order book is looked up once, and applied in submission order within each stock, which gives the
+    // same result as submitting them one by one. results is only grown if it is smaller than orders.
+    // Account valuations match too, but top-N ties may come out in a different order, since topExposures
+    // breaks ties by how recently each account was updated and netting changes that.
+    void submitBatch(const vector<BatchOrder>& orders, vector<BatchResult>& results) {
+        if (results.size() < orders.size()) {
+            results.resize(orders.size());
+        }
+        map<string, vector<size_t>> groups; // Stock name -> indices into orders
+        for (size_t i = 0; i < orders.size(); ++i) {
+            groups[orders[i].stockName].push_back(i);
+        }
+        for (const auto& group : groups) {
+            auto stock = stocks.find(group.first);
+            if (stock == stocks.end()) {
+                cout << "Stock " << group.first << " not found in the market." << endl;
+                for (size_t index : group.second) {
+                    results[index] = {BatchResult::STOCK_NOT_FOUND, 0, 0, 0};
+                }
+                continue;
+            }
+            stock->second.applyBatch(orders, group.second, results, group.first);
         }
-        stocks[stockName].sellOrder(price, quantity, user, stockName);
     }
 
     // Function to display the order book of a specific stock
@@ -191,6 +501,51 @@ public:
         stocks[stockName].printBook();
     }
 
+    // Function to get an account's mark-to-market P&L (0 if it has never traded)
+    long long getPnl(UserProfile& user) {
+        return valuation.getPnl(user);
+    }
+
+    // Function to get an account's net exposure: sum of position * last traded price
+    long long getNetExposure(UserProfile& user) {
+        return valuation.getNetExposure(user);
+    }
+
+    // Function to get an account's gross exposure: sum of |position| * last traded price
+    long long getGrossExposure(UserProfile& user) {
+        return valuation.getGrossExposure(user);
+    }
+
+    // Function to get the n accounts with the largest gross exposure as (gross exposure, user), largest first
+    vector<pair<long long, UserProfile*>> topExposures(size_t n) {
+        return valuation.topExposures(n);
+    }
+
+    long long getFirmPnl() {
+        return valuation.getFirmPnl();
+    }
+
+    long long getFirmNetExposure() {
+        return valuation.getFirmNetExposure();
+    }
+
+    long long getFirmGrossExposure() {
+        return valuation.getFirmGrossExposure();
+    }
+
+    // Function to display firm-wide P&L and exposure and the accounts with the largest gross exposure
+    void displayExposureSummary(size_t topN) {
+        cout << "****** Firm P&L : " << getFirmPnl() << " ******" << endl;
+        cout << "Net Exposure: " << getFirmNetExposure() << ", Gross Exposure: " << getFirmGrossExposure() << endl;
+        cout << "Top " << topN << " Accounts by Gross Exposure:" << endl;
+        for (const auto& entry : topExposures(topN)) {
+            cout << "  " << entry.second->username << ": gross " << getGrossExposure(*entry.second)
+                 << ", net " << getNetExposure(*entry.second)
+                 << ", P&L " << getPnl(*entry.second) << endl;
+        }
+        cout << "************************************************" << endl << endl;
+    }
+
     // Function to display the last traded prices of all stocks
     void displayLastTradedPrices() {
         cout << "****** Last Traded Prices for All Stocks ******" << endl;
@@ -330,6 +685,7 @@ int main() {
             cin >> password;
             if (management.login(username, password)) {
                 cout << "Management login successful!" << endl;
+                market.displayExposureSummary(5);
                 management.listStock(market);
             } else {
                 cout << "Invalid credentials! Access denied." << endl;
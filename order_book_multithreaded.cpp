@@ -15,8 +15,8 @@ public:
     string username;
     int balance;
     map<string, int> stocksOwned; // Company name -> Number of stocks owned
-    map<string, vector<pair<int, int>>> buyOrders;  // Company name -> List of (price, quantity) buy orders
-    map<string, vector<pair<int, int>>> sellOrders; // Company name -> List of (price, quantity) sell orders
+    map<string, map<int, pair<int, int>>> buyOrders;  // Company name -> Order id -> (price, remaining quantity) of resting buy orders
+    map<string, map<int, pair<int, int>>> sellOrders; // Company name -> Order id -> (price, remaining quantity) of resting sell orders
 
     UserProfile() : username(""), balance(0) {}  // Default constructor
 
@@ -35,107 +35,383 @@ public:
         for (const auto& order : buyOrders) {
             cout << "  " << order.first << ":" << endl;
             for (const auto& p : order.second) {
-                cout << "    Price: " << p.first << ", Quantity: " << p.second << endl;
+                cout << "    Order " << p.first << ": Price: " << p.second.first << ", Quantity: " << p.second.second << endl;
             }
         }
         cout << "Sell Orders:" << endl;
         for (const auto& order : sellOrders) {
             cout << "  " << order.first << ":" << endl;
             for (const auto& p : order.second) {
-                cout << "    Price: " << p.first << ", Quantity: " << p.second << endl;
+                cout << "    Order " << p.first << ": Price: " << p.second.first << ", Quantity: " << p.second.second << endl;
             }
         }
         cout << endl;
     }
 
+    // The functions below change the user's holdings and orders; callers must already hold userMutex
+
     // Function to add buy order
-    void addBuyOrder(const string& stockName, int price, int quantity) {
-        lock_guard<mutex> lock(userMutex);
-        buyOrders[stockName].push_back(make_pair(price, quantity));
+    void addBuyOrder(const string& stockName, int orderId, int price, int quantity) {
+        buyOrders[stockName][orderId] = make_pair(price, quantity);
     }
 
     // Function to add sell order
-    void addSellOrder(const string& stockName, int price, int quantity) {
-        lock_guard<mutex> lock(userMutex);
-        sellOrders[stockName].push_back(make_pair(price, quantity));
+    void addSellOrder(const string& stockName, int orderId, int price, int quantity) {
+        sellOrders[stockName][orderId] = make_pair(price, quantity);
     }
 
     // Function to update stocks owned after a trade
     void updateStocksOwned(const string& stockName, int quantity) {
-        lock_guard<mutex> lock(userMutex);
         stocksOwned[stockName] += quantity;
         if (stocksOwned[stockName] == 0) {
             stocksOwned.erase(stockName);
         }
     }
 
-    // Function to remove a completed order
-    void removeCompletedOrder(map<string, vector<pair<int, int>>>& orders, const string& stockName, int price, int quantity) {
-        lock_guard<mutex> lock(userMutex);
-        auto& orderList = orders[stockName];
-        for (auto it = orderList.begin(); it != orderList.end(); ++it) {
-            if (it->first == price && it->second == quantity) {
-                orderList.erase(it);
-                break;
+    // Function to take filled or cancelled quantity off a resting order, removing it once nothing is left
+    void reduceOrder(map<string, map<int, pair<int, int>>>& orders, const string& stockName, int orderId, int quantity) {
+        auto stock = orders.find(stockName);
+        if (stock == orders.end()) return;
+        auto order = stock->second.find(orderId);
+        if (order == stock->second.end()) return;
+        order->second.second -= quantity;
+        if (order->second.second <= 0) {
+            stock->second.erase(order);
+        }
+        if (stock->second.empty()) {
+            orders.erase(stock);
+        }
+    }
+};
+
+// Single buy, sell or cancel entry of a batch submission
+struct BatchOrder {
+    enum Type { BUY, SELL, CANCEL };
+    Type type;
+    string stockName;
+    int price;
+    int quantity;
+    UserProfile* user;
+    int orderId; // Order to cancel (CANCEL only)
+};
+
+// Outcome of one batch entry, written to the slot with the same index as the order
+struct BatchResult {
+    enum Status { OK, STOCK_NOT_FOUND, ORDER_NOT_FOUND };
+    Status status;
+    int filledQuantity;  // Quantity traded (buy/sell) or removed from the book (cancel)
+    int restingQuantity; // Quantity of the order left resting on the book
+    int orderId;         // Id assigned to a buy/sell, usable for a later cancel
+};
+
+// Class to keep a live mark-to-market valuation of every account that has traded.
+// A fill only touches the two accounts on either side of it, and a price change only touches
+// the holders of that stock, so nothing ever rescans all users or all stocks.
+// All members must be called with marketMutex held (fills are reported with userMutex held as well).
+class PortfolioValuation {
+    struct Account {
+        UserProfile* user;
+        int initialBalance;
+        int cash;
+        long long netExposure;   // Sum of position * price over all stocks
+        long long grossExposure; // Sum of |position| * price over all stocks
+        unsigned version;        // Bumped on every change so stale heap entries can be skipped
+    };
+
+    map<UserProfile*, Account> accounts;
+    map<string, int> prices;                    // Stock -> price used for valuation
+    map<string, map<Account*, int>> holders;    // Stock -> accounts with a non-zero position -> position
+    priority_queue<tuple<long long, unsigned, Account*>> exposureHeap; // (gross exposure, version, account)
+    long long firmNet = 0;
+    long long firmGross = 0;
+    long long firmPnl = 0;
+
+    // Applies a change to one account and the firm totals, and refreshes its heap entry
+    void update(Account& account, long long netChange, long long grossChange, int cashChange) {
+        account.cash += cashChange;
+        account.netExposure += netChange;
+        account.grossExposure += grossChange;
+        firmNet += netChange;
+        firmGross += grossChange;
+        firmPnl += netChange + cashChange;
+        ++account.version;
+        exposureHeap.push(make_tuple(account.grossExposure, account.version, &account));
+        // Drop stale entries once they outnumber live ones so the heap stays proportional to the accounts
+        if (exposureHeap.size() > 2 * accounts.size() + 64) {
+            exposureHeap = priority_queue<tuple<long long, unsigned, Account*>>();
+            for (auto& entry : accounts) {
+                exposureHeap.push(make_tuple(entry.second.grossExposure, entry.second.version, &entry.second));
             }
         }
-        if (orderList.empty()) {
-            orders.erase(stockName);
+    }
+
+public:
+    // Function to record a user's net fill on a stock after their balance and holdings were updated
+    void onFill(UserProfile& user, const string& stockName, int quantity, int cashChange) {
+        auto found = accounts.find(&user);
+        if (found == accounts.end()) {
+            int startingBalance = user.balance - cashChange;
+            found = accounts.emplace(&user, Account{&user, startingBalance, startingBalance, 0, 0, 0}).first;
+        }
+        Account& account = found->second;
+        long long price = prices[stockName];
+        map<Account*, int>& stockHolders = holders[stockName];
+        auto holding = stockHolders.find(&account);
+        int before = holding == stockHolders.end() ? 0 : holding->second;
+        int after = before + quantity;
+        if (after == 0) {
+            if (holding != stockHolders.end()) stockHolders.erase(holding);
+        } else {
+            stockHolders[&account] = after;
+        }
+        update(account, (after - before) * price, (long long)(abs(after) - abs(before)) * price, cashChange);
+    }
+
+    // Function to revalue the holders of a stock after its last traded price changed
+    void onPrice(const string& stockName, int price) {
+        int& current = prices[stockName];
+        long long change = price - current;
+        if (change == 0) return;
+        current = price;
+        for (auto& holding : holders[stockName]) {
+            update(*holding.first, holding.second * change, abs(holding.second) * change, 0);
+        }
+    }
+
+    // Function to get the n accounts with the largest gross exposure, largest first
+    vector<pair<long long, UserProfile*>> topExposures(size_t n) {
+        vector<pair<long long, UserProfile*>> top;
+        vector<tuple<long long, unsigned, Account*>> live;
+        while (!exposureHeap.empty() && live.size() < n) {
+            auto entry = exposureHeap.top();
+            exposureHeap.pop();
+            if (get<1>(entry) != get<2>(entry)->version) continue;
+            live.push_back(entry);
+            top.push_back(make_pair(get<0>(entry), get<2>(entry)->user));
+        }
+        for (const auto& entry : live) {
+            exposureHeap.push(entry);
         }
+        return top;
+    }
+
+    // Mark-to-market P&L of one account: cash plus position value minus its balance before its first fill
+    long long getPnl(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        if (found == accounts.end()) return 0;
+        return found->second.cash + found->second.netExposure - found->second.initialBalance;
+    }
+
+    long long getNetExposure(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        return found == accounts.end() ? 0 : found->second.netExposure;
     }
+
+    long long getGrossExposure(UserProfile& user) const {
+        auto found = accounts.find(&user);
+        return found == accounts.end() ? 0 : found->second.grossExposure;
+    }
+
+    long long getFirmPnl() const { return firmPnl; }
+    long long getFirmNetExposure() const { return firmNet; }
+    long long getFirmGrossExposure() const { return firmGross; }
 };
 
 // Class to manage the order book for a single stock
 class OrderBook {
-    priority_queue<pair<int, int>> buy;  // max-heap for buy orders (price -> quantity)
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> sell; // min-heap for sell orders
-    int ltp; // last traded price
+    // An order waiting on the book, in time priority within its price level
+    struct RestingOrder {
+        int id;
+        UserProfile* owner;
+        int quantity; // Quantity still unfilled
+    };
 
-public:
-    OrderBook() : ltp(0) {}
+    // Where a resting order lives, so it can be cancelled without scanning the book
+    struct OrderLocation {
+        bool isBuy;
+        int price;
+        list<RestingOrder>::iterator entry;
+    };
 
-    // Function to place a buy order
-    void buyOrder(int price, int quantity, UserProfile& user, const string& stockName) {
-        user.addBuyOrder(stockName, price, quantity);
-        lock_guard<mutex> lock(marketMutex);
-        while (quantity > 0 && !sell.empty() && sell.top().first <= price) {
-            auto bestSell = sell.top();
-            int tradeQuantity = min(quantity, bestSell.second);
-            ltp = bestSell.first;
+    map<int, list<RestingOrder>> buy;  // price -> resting buy orders
+    map<int, list<RestingOrder>> sell; // price -> resting sell orders
+    map<int, OrderLocation> ordersById;
+    int nextOrderId;
+    int ltp; // last traded price
+    PortfolioValuation* valuation; // Notified of fills and price changes, if set
+
+    // Matches an incoming buy against resting sells and rests what is left under orderId.
+    // Returns the filled quantity; balance and stocks changes for both sides of each trade are added to deltas. Caller must hold marketMutex and userMutex.
+    int matchBuy(int orderId, int price, int& quantity, UserProfile& user, const string& stockName,
+                 map<UserProfile*, pair<int, int>>& deltas) {
+        int filled = 0;
+        while (quantity > 0 && !sell.empty() && sell.begin()->first <= price) {
+            auto level = sell.begin();
+            RestingOrder& bestSell = level->second.front();
+            int tradeQuantity = min(quantity, bestSell.quantity);
+            ltp = level->first;
             quantity -= tradeQuantity;
-            user.balance -= ltp * tradeQuantity;
-            user.updateStocksOwned(stockName, tradeQuantity);
-            sell.pop();
-            if (bestSell.second > tradeQuantity) {
-                sell.push(make_pair(bestSell.first, bestSell.second - tradeQuantity));
+            filled += tradeQuantity;
+            deltas[&user].first -= ltp * tradeQuantity;
+            deltas[&user].second += tradeQuantity;
+            deltas[bestSell.owner].first += ltp * tradeQuantity;
+            deltas[bestSell.owner].second -= tradeQuantity;
+            bestSell.quantity -= tradeQuantity;
+            bestSell.owner->reduceOrder(bestSell.owner->sellOrders, stockName, bestSell.id, tradeQuantity);
+            if (bestSell.quantity == 0) {
+                ordersById.erase(bestSell.id);
+                level->second.pop_front();
+                if (level->second.empty()) sell.erase(level);
             }
-            user.removeCompletedOrder(user.sellOrders, stockName, ltp, tradeQuantity);
         }
         if (quantity > 0) {
-            buy.push(make_pair(price, quantity));
+            auto& orders = buy[price];
+            orders.push_back({orderId, &user, quantity});
+            ordersById[orderId] = {true, price, prev(orders.end())};
+            user.addBuyOrder(stockName, orderId, price, quantity);
         }
+        return filled;
     }
 
-    // Function to place a sell order
-    void sellOrder(int price, int quantity, UserProfile& user, const string& stockName) {
-        user.addSellOrder(stockName, price, quantity);
-        lock_guard<mutex> lock(marketMutex);
-        while (quantity > 0 && !buy.empty() && buy.top().first >= price) {
-            auto bestBuy = buy.top();
-            int tradeQuantity = min(quantity, bestBuy.second);
-            ltp = bestBuy.first;
+    // Matches an incoming sell against resting buys and rests what is left under orderId.
+    // Returns the filled quantity; balance and stocks changes for both sides of each trade are added to deltas. Caller must hold marketMutex and userMutex.
+    int matchSell(int orderId, int price, int& quantity, UserProfile& user, const string& stockName,
+                  map<UserProfile*, pair<int, int>>& deltas) {
+        int filled = 0;
+        while (quantity > 0 && !buy.empty() && buy.rbegin()->first >= price) {
+            auto level = --buy.end();
+            RestingOrder& bestBuy = level->second.front();
+            int tradeQuantity = min(quantity, bestBuy.quantity);
+            ltp = level->first;
             quantity -= tradeQuantity;
-            user.balance += ltp * tradeQuantity;
-            user.updateStocksOwned(stockName, -tradeQuantity);
-            buy.pop();
-            if (bestBuy.second > tradeQuantity) {
-                buy.push(make_pair(bestBuy.first, bestBuy.second - tradeQuantity));
+            filled += tradeQuantity;
+            deltas[&user].first += ltp * tradeQuantity;
+            deltas[&user].second -= tradeQuantity;
+            deltas[bestBuy.owner].first -= ltp * tradeQuantity;
+            deltas[bestBuy.owner].second += tradeQuantity;
+            bestBuy.quantity -= tradeQuantity;
+            bestBuy.owner->reduceOrder(bestBuy.owner->buyOrders, stockName, bestBuy.id, tradeQuantity);
+            if (bestBuy.quantity == 0) {
+                ordersById.erase(bestBuy.id);
+                level->second.pop_front();
+                if (level->second.empty()) buy.erase(level);
             }
-            user.removeCompletedOrder(user.buyOrders, stockName, ltp, tradeQuantity);
         }
         if (quantity > 0) {
-            sell.push(make_pair(price, quantity));
+            auto& orders = sell[price];
+            orders.push_back({orderId, &user, quantity});
+            ordersById[orderId] = {false, price, prev(orders.end())};
+            user.addSellOrder(stockName, orderId, price, quantity);
+        }
+        return filled;
+    }
+
+    // Removes the user's resting order with the given id; returns false if it is not on the book or not theirs. Caller must hold marketMutex and userMutex.
+    bool removeOrder(int orderId, UserProfile& user, const string& stockName, int& cancelled) {
+        auto found = ordersById.find(orderId);
+        if (found == ordersById.end() || found->second.entry->owner != &user) {
+            return false;
+        }
+        OrderLocation location = found->second;
+        map<int, list<RestingOrder>>& side = location.isBuy ? buy : sell;
+        cancelled = location.entry->quantity;
+        user.reduceOrder(location.isBuy ? user.buyOrders : user.sellOrders, stockName, orderId, cancelled);
+        auto level = side.find(location.price);
+        level->second.erase(location.entry);
+        if (level->second.empty()) side.erase(level);
+        ordersById.erase(found);
+        return true;
+    }
+
+    // Applies the netted balance and stocks changes of one or more orders and reports them for valuation. Caller must hold marketMutex and userMutex.
+    void settle(const map<UserProfile*, pair<int, int>>& deltas, const string& stockName) {
+        for (const auto& delta : deltas) {
+            delta.first->balance += delta.second.first;
+            delta.first->updateStocksOwned(stockName, delta.second.second);
+            if (valuation) valuation->onFill(*delta.first, stockName, delta.second.second, delta.second.first);
         }
+        if (valuation && !deltas.empty()) {
+            valuation->onPrice(stockName, ltp);
+        }
+    }
+
+    // Total quantity resting at one price level
+    static int levelQuantity(const list<RestingOrder>& orders) {
+        int total = 0;
+        for (const auto& order : orders) total += order.quantity;
+        return total;
+    }
+
+public:
+    OrderBook(PortfolioValuation* valuation = nullptr) : nextOrderId(1), ltp(0), valuation(valuation) {}
+
+    // Function to place a buy order; returns the id of the order
+    int buyOrder(int price, int quantity, UserProfile& user, const string& stockName) {
+        lock(marketMutex, userMutex);
+        lock_guard<mutex> marketLock(marketMutex, adopt_lock);
+        lock_guard<mutex> userLock(userMutex, adopt_lock);
+        int orderId = nextOrderId++;
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        matchBuy(orderId, price, quantity, user, stockName, deltas);
+        settle(deltas, stockName);
+        return orderId;
+    }
+
+    // Function to place a sell order; returns the id of the order
+    int sellOrder(int price, int quantity, UserProfile& user, const string& stockName) {
+        lock(marketMutex, userMutex);
+        lock_guard<mutex> marketLock(marketMutex, adopt_lock);
+        lock_guard<mutex> userLock(userMutex, adopt_lock);
+        int orderId = nextOrderId++;
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        matchSell(orderId, price, quantity, user, stockName, deltas);
+        settle(deltas, stockName);
+        return orderId;
+    }
+
+    // Function to cancel one of the user's resting orders; cancelled is set to the quantity removed from the book
+    bool cancelOrder(int orderId, UserProfile& user, const string& stockName, int& cancelled) {
+        lock(marketMutex, userMutex);
+        lock_guard<mutex> marketLock(marketMutex, adopt_lock);
+        lock_guard<mutex> userLock(userMutex, adopt_lock);
+        return removeOrder(orderId, user, stockName, cancelled);
+    }
+
+    // Function to apply the entries of a batch that target this stock, in submission order, under a single
+    // acquisition of marketMutex and userMutex.
+    // Balance and holdings changes are netted per user and applied once at the end of the batch.
+    void applyBatch(const vector<BatchOrder>& orders, const vector<size_t>& indices, vector<BatchResult>& results,
+                    const string& stockName) {
+        lock(marketMutex, userMutex);
+        lock_guard<mutex> marketLock(marketMutex, adopt_lock);
+        lock_guard<mutex> userLock(userMutex, adopt_lock);
+        map<UserProfile*, pair<int, int>> deltas; // User -> (balance change, stocks change)
+        for (size_t index : indices) {
+            const BatchOrder& order = orders[index];
+            UserProfile& user = *order.user;
+            BatchResult& result = results[index];
+            int quantity = order.quantity;
+            result = {BatchResult::OK, 0, 0, 0};
+            switch (order.type) {
+            case BatchOrder::BUY:
+                result.orderId = nextOrderId++;
+                result.filledQuantity = matchBuy(result.orderId, order.price, quantity, user, stockName, deltas);
+                result.restingQuantity = quantity;
+                break;
+            case BatchOrder::SELL:
+                result.orderId = nextOrderId++;
+                result.filledQuantity = matchSell(result.orderId, order.price, quantity, user, stockName, deltas);
+                result.restingQuantity = quantity;
+                break;
+            case BatchOrder::CANCEL:
+                result.orderId = order.orderId;
+                if (!removeOrder(order.orderId, user, stockName, result.filledQuantity)) {
+                    result.status = BatchResult::ORDER_NOT_FOUND;
+                }
+                break;
+            }
+        }
+        settle(deltas, stockName);
     }
 
     // Function to display the current state of the order book
@@ -145,23 +421,17 @@ public:
         cout << "----------------------------------------" << endl;
         cout << "|      Price      |      Quantity      |" << endl;
         cout << "----------------------------------------" << endl;
-        priority_queue<pair<int, int>> buyCopy = buy;
-        while (!buyCopy.empty()) {
-            auto order = buyCopy.top();
-            buyCopy.pop();
-            cout << "|   " << setw(7) << order.first << "   |   " << setw(9) << order.second << "   |" << endl;
+        for (auto it = buy.rbegin(); it != buy.rend(); ++it) {
+            cout << "|   " << setw(7) << it->first << "   |   " << setw(9) << levelQuantity(it->second) << "   |" << endl;
         }
         cout << "----------------------------------------" << endl;
 
-        cout << "****** ******   Sell Orders  *************" << endl;
+        cout << "************   Sell Orders  *************" << endl;
         cout << "----------------------------------------" << endl;
         cout << "|      Price      |      Quantity      |" << endl;
         cout << "----------------------------------------" << endl;
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> sellCopy = sell;
-        while (!sellCopy.empty()) {
-            auto order = sellCopy.top();
-            sellCopy.pop();
-            cout << "|      " << setw(7) << order.first << "      |      " << setw(9) << order.second << "      |" << endl;
+        for (const auto& it : sell) {
+            cout << "|      " << setw(7) << it.first << "      |      " << setw(9) << levelQuantity(it.second) << "      |" << endl;
         }
         cout << "----------------------------------------" << endl;
 
@@ -176,35 +446,76 @@ public:
 // Class to manage all stocks and their respective order books
 class StockMarket {
     map<string, OrderBook> stocks;
+    PortfolioValuation valuation;
 
 public:
-    // Function to list a new stock in the market
-    void listStock(const string& stockName) {
+    // Function to list a new stock in the market; quiet skips the confirmation message
+    void listStock(const string& stockName, bool quiet = false) {
         lock_guard<mutex> lock(marketMutex);
         if (stocks.find(stockName) != stocks.end()) {
             cout << "Stock already listed in the market." << endl;
         } else {
-            stocks[stockName] = OrderBook();
-            cout << "Stock " << stockName << " listed successfully!" << endl;
+            stocks[stockName] = OrderBook(&valuation);
+            if (!quiet) cout << "Stock " << stockName << " listed successfully!" << endl;
         }
     }
 
-    // Function to place a buy order for a specific stock
-    void buyOrder(const string& stockName, int price, int quantity, UserProfile& user) {
+    // Function to place a buy order for a specific stock; returns the order id, or -1 if the stock is not listed
+    int buyOrder(const string& stockName, int price, int quantity, UserProfile& user) {
         if (stocks.find(stockName) == stocks.end()) {
             cout << "Stock not found in the market." << endl;
-            return;
+            return -1;
         }
-        (void)async(launch::async, &OrderBook::buyOrder, &stocks[stockName], price, quantity, ref(user), stockName);
+        return async(launch::async, &OrderBook::buyOrder, &stocks[stockName], price, quantity, ref(user), stockName).get();
     }
 
-    // Function to place a sell order for a specific stock
-    void sellOrder(const string& stockName, int price, int quantity, UserProfile& user) {
+    // Function to place a sell order for a specific stock; returns the order id, or -1 if the stock is not listed
+    int sellOrder(const string& stockName, int price, int quantity, UserProfile& user) {
         if (stocks.find(stockName) == stocks.end()) {
             cout << "Stock not found in the market." << endl;
-            return;
+            return -1;
+        }
+        return async(launch::async, &OrderBook::sellOrder, &stocks[stockName], price, quantity, ref(user), stockName).get();
+    }
+
+    // Function to cancel one of the user's resting orders for a specific stock; returns the quantity removed.
+    // quiet skips the message when the order is no longer on the book.
+    int cancelOrder(const string& stockName, int orderId, UserProfile& user, bool quiet = false) {
+        if (stocks.find(stockName) == stocks.end()) {
+            cout << "Stock not found in the market." << endl;
+            return 0;
+        }
+        int cancelled = 0;
+        if (!stocks[stockName].cancelOrder(orderId, user, stockName, cancelled) && !quiet) {
+            cout << "Order not found." << endl;
+        }
+        return cancelled;
+    }
+
+    // Function to submit a burst of orders and cancels at once. Entries are grouped by stock so each
+    // order book is looked up and locked once, and applied in submission order within each stock, which
+    // gives the same result as submitting them one by one. results is only grown if it is smaller than orders.
+    // Account valuations match too, but top-N ties may come out in a different order, since topExposures
+    // breaks ties by how recently each account was updated and netting changes that.
+    void submitBatch(const vector<BatchOrder>& orders, vector<BatchResult>& results) {
+        if (results.size() < orders.size()) {
+            results.resize(orders.size());
+        }
+        map<string, vector<size_t>> groups; // Stock name -> indices into orders
+        for (size_t i = 0; i < orders.size(); ++i) {
+            groups[orders[i].stockName].push_back(i);
+        }
+        for (const auto& group : groups) {
+            auto stock = stocks.find(group.first);
+            if (stock == stocks.end()) {
+                cout << "Stock " << group.first << " not found in the market." << endl;
+                for (size_t index : group.second) {
+                    results[index] = {BatchResult::STOCK_NOT_FOUND, 0, 0, 0};
+                }
+                continue;
+            }
+            stock->second.applyBatch(orders, group.second, results, group.first);
         }
-        (void)async(launch::async, &OrderBook::sellOrder, &stocks[stockName], price, quantity, ref(user), stockName);
     }
 
     // Function to display the order book of a specific stock
@@ -216,6 +527,65 @@ public:
         async(launch::async, &OrderBook::printBook, &stocks[stockName]).get();
     }
 
+    // Function to get the last traded price of a specific stock (0 if not listed or not yet traded)
+    int getLastTradedPrice(const string& stockName) {
+        lock_guard<mutex> lock(marketMutex);
+        auto stock = stocks.find(stockName);
+        return stock == stocks.end() ? 0 : stock->second.getLastTradedPrice();
+    }
+
+    // Function to get an account's mark-to-market P&L (0 if it has never traded)
+    long long getPnl(UserProfile& user) {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getPnl(user);
+    }
+
+    // Function to get an account's net exposure: sum of position * last traded price
+    long long getNetExposure(UserProfile& user) {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getNetExposure(user);
+    }
+
+    // Function to get an account's gross exposure: sum of |position| * last traded price
+    long long getGrossExposure(UserProfile& user) {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getGrossExposure(user);
+    }
+
+    // Function to get the n accounts with the largest gross exposure as (gross exposure, user), largest first
+    vector<pair<long long, UserProfile*>> topExposures(size_t n) {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.topExposures(n);
+    }
+
+    long long getFirmPnl() {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getFirmPnl();
+    }
+
+    long long getFirmNetExposure() {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getFirmNetExposure();
+    }
+
+    long long getFirmGrossExposure() {
+        lock_guard<mutex> lock(marketMutex);
+        return valuation.getFirmGrossExposure();
+    }
+
+    // Function to display firm-wide P&L and exposure and the accounts with the largest gross exposure
+    void displayExposureSummary(size_t topN) {
+        cout << "****** Firm P&L : " << getFirmPnl() << " ******" << endl;
+        cout << "Net Exposure: " << getFirmNetExposure() << ", Gross Exposure: " << getFirmGrossExposure() << endl;
+        cout << "Top " << topN << " Accounts by Gross Exposure:" << endl;
+        for (const auto& entry : topExposures(topN)) {
+            cout << "  " << entry.second->username << ": gross " << getGrossExposure(*entry.second)
+                 << ", net " << getNetExposure(*entry.second)
+                 << ", P&L " << getPnl(*entry.second) << endl;
+        }
+        cout << "************************************************" << endl << endl;
+    }
+
     // Function to display the last traded prices of all stocks
     void displayLastTradedPrices() {
         cout << "****** Last Traded Prices for All Stocks ******" << endl;
@@ -231,14 +601,14 @@ class UserManager {
     map<string, UserProfile> users;
 
 public:
-    // Function to sign up a new user
-    void signUp(string username) {
+    // Function to sign up a new user; quiet skips the confirmation message
+    void signUp(string username, bool quiet = false) {
         lock_guard<mutex> lock(userMutex);
         if (users.find(username) != users.end()) {
             cout << "Username already taken. Please choose another one." << endl;
         } else {
             users[username] = UserProfile(username);
-            cout << "User " << username << " created successfully!" << endl;
+            if (!quiet) cout << "User " << username << " created successfully!" << endl;
         }
     }
 
@@ -270,11 +640,414 @@ public:
     }
 };
 
-int main() {
+// Settings for the synthetic load generator
+struct LoadConfig {
+    int users = 1000;              // Number of accounts to sign up
+    int symbols = 24;              // Number of stocks to list
+    double rate = 5000;            // Target average orders per second
+    double seconds = 10;           // Length of the run
+    string arrivals = "poisson";   // Arrival model: "poisson" or "hawkes"
+    double hawkesBranching = 0.5;  // Expected child events per event (must be < 1)
+    double hawkesDecay = 50;       // Decay rate of self-excitation, per second
+    double zipfExponent = 1.0;     // Skew of symbol popularity (0 = uniform)
+    double cancelRatio = 0.2;      // Fraction of events that cancel a resting order
+    double replaceRatio = 0.1;     // Fraction of events that cancel and re-place a resting order
+    double reportInterval = 1.0;   // Seconds between progress rows
+    int threads = 8;               // Sender threads sharing the schedule
+    int batch = 1;                 // Orders per event; above 1 each event is one account's burst sent as a batch
+    unsigned seed = 42;
+};
+
+// Drives many accounts and symbols through the market at a fixed open-loop schedule.
+// Arrival times are generated up front and handed out in order to a pool of sender threads.
+// Latency is measured from each order's intended send time, so a stalled market shows up as
+// latency and backlog instead of a lower send rate.
+class LoadGenerator {
+    using Clock = chrono::steady_clock;
+
+    LoadConfig config;
+    mt19937_64 scheduleRng;
+    vector<string> symbols;
+    vector<UserProfile*> accounts;
+    vector<double> zipfCdf;     // Cumulative symbol popularity
+    vector<double> arrivals;    // Intended send time of each event, seconds from start
+    vector<double> completions; // Time each event finished, seconds from start
+    atomic<size_t> nextEvent;   // Next schedule slot to be claimed by a sender
+    atomic<size_t> finished;    // Number of events sent so far
+    Clock::time_point start;
+
+    static double uniform(mt19937_64& rng) {
+        return uniform_real_distribution<double>(0.0, 1.0)(rng);
+    }
+
+    static int uniformInt(mt19937_64& rng, int low, int high) {
+        return uniform_int_distribution<int>(low, high)(rng);
+    }
+
+    // Intended send times in seconds from the start of the run
+    vector<double> scheduleArrivals() {
+        vector<double> times;
+        times.reserve((size_t)(config.rate * config.seconds * 1.1));
+        if (config.arrivals == "hawkes") {
+            // Ogata thinning; the base rate is scaled so the long-run average matches config.rate
+            double base = config.rate * (1.0 - config.hawkesBranching);
+            double jump = config.hawkesBranching * config.hawkesDecay;
+            double excitation = 0, t = 0;
+            while (true) {
+                double bound = base + excitation;
+                double wait = exponential_distribution<double>(bound)(scheduleRng);
+                t += wait;
+                if (t >= config.seconds) break;
+                excitation *= exp(-config.hawkesDecay * wait);
+                if (uniform(scheduleRng) * bound <= base + excitation) {
+                    times.push_back(t);
+                    excitation += jump;
+                }
+            }
+        } else {
+            exponential_distribution<double> gap(config.rate);
+            for (double t = gap(scheduleRng); t < config.seconds; t += gap(scheduleRng)) {
+                times.push_back(t);
+            }
+        }
+        return times;
+    }
+
+    const string& pickSymbol(mt19937_64& rng) {
+        size_t index = upper_bound(zipfCdf.begin(), zipfCdf.end(), uniform(rng) * zipfCdf.back()) - zipfCdf.begin();
+        return symbols[min(index, symbols.size() - 1)];
+    }
+
+    // Picks one of the user's orders still resting on a stock; returns false if there is none.
+    // The user's order records only hold live orders, since fills and cancels remove them.
+    bool pickRestingOrder(mt19937_64& rng, UserProfile& user, const string& stockName, bool& isBuy, int& orderId,
+                          pair<int, int>& order) {
+        lock_guard<mutex> lock(userMutex);
+        auto buys = user.buyOrders.find(stockName);
+        auto sells = user.sellOrders.find(stockName);
+        size_t buyCount = buys == user.buyOrders.end() ? 0 : buys->second.size();
+        size_t sellCount = sells == user.sellOrders.end() ? 0 : sells->second.size();
+        if (buyCount + sellCount == 0) return false;
+        size_t index = uniform_int_distribution<size_t>(0, buyCount + sellCount - 1)(rng);
+        isBuy = index < buyCount;
+        auto picked = isBuy ? next(buys->second.begin(), index) : next(sells->second.begin(), index - buyCount);
+        orderId = picked->first;
+        order = picked->second;
+        return true;
+    }
+
+    // Chooses a new order on a stock, priced around its last traded price
+    void pickNewOrder(StockMarket& market, mt19937_64& rng, const string& stockName, bool& isBuy, int& price, int& quantity) {
+        int reference = market.getLastTradedPrice(stockName);
+        if (reference == 0) reference = 100;
+        quantity = uniformInt(rng, 1, 10);
+        isBuy = uniform(rng) < 0.5;
+        price = max(1, reference + (isBuy ? uniformInt(rng, -5, 2) : uniformInt(rng, -2, 5)));
+    }
+
+    // Sends one event of the order flow to the market
+    void sendEvent(StockMarket& market, mt19937_64& rng) {
+        UserProfile& user = *accounts[uniformInt(rng, 0, (int)accounts.size() - 1)];
+        const string& stockName = pickSymbol(rng);
+        double action = uniform(rng);
+        bool isBuy;
+        int orderId;
+        pair<int, int> resting;
+        if (action < config.cancelRatio + config.replaceRatio && pickRestingOrder(rng, user, stockName, isBuy, orderId, resting)) {
+            // Another sender may fill the order first, so a miss here is expected and not reported
+            int cancelled = market.cancelOrder(stockName, orderId, user, true);
+            if (action < config.cancelRatio || cancelled == 0) return;
+            // Re-place only what the cancel actually took off the book
+            int price = max(1, resting.first + uniformInt(rng, -2, 2));
+            if (isBuy) {
+                market.buyOrder(stockName, price, cancelled, user);
+            } else {
+                market.sellOrder(stockName, price, cancelled, user);
+            }
+            return;
+        }
+        int price, quantity;
+        pickNewOrder(market, rng, stockName, isBuy, price, quantity);
+        if (isBuy) {
+            market.buyOrder(stockName, price, quantity, user);
+        } else {
+            market.sellOrder(stockName, price, quantity, user);
+        }
+    }
+
+    // Sends one event as a burst of config.batch orders and cancels from a single account through
+    // submitBatch, the way a market maker refreshes its quotes. Replacements are sized from what each
+    // cancel actually removed, so they go out in a second batch once the first one's results are in.
+    void sendBurst(StockMarket& market, mt19937_64& rng, vector<BatchOrder>& orders, vector<BatchResult>& results) {
+        UserProfile& user = *accounts[uniformInt(rng, 0, (int)accounts.size() - 1)];
+        vector<pair<size_t, BatchOrder>> replacements; // Index of the cancel in orders -> order that replaces it
+        orders.clear();
+        for (int k = 0; k < config.batch; ++k) {
+            const string& stockName = pickSymbol(rng);
+            double action = uniform(rng);
+            bool isBuy;
+            int orderId;
+            pair<int, int> resting;
+            if (action < config.cancelRatio + config.replaceRatio && pickRestingOrder(rng, user, stockName, isBuy, orderId, resting)) {
+                orders.push_back({BatchOrder::CANCEL, stockName, 0, 0, &user, orderId});
+                if (action >= config.cancelRatio) {
+                    int price = max(1, resting.first + uniformInt(rng, -2, 2));
+                    replacements.push_back(make_pair(orders.size() - 1,
+                        BatchOrder{isBuy ? BatchOrder::BUY : BatchOrder::SELL, stockName, price, 0, &user, 0}));
+                }
+                continue;
+            }
+            int price, quantity;
+            pickNewOrder(market, rng, stockName, isBuy, price, quantity);
+            orders.push_back({isBuy ? BatchOrder::BUY : BatchOrder::SELL, stockName, price, quantity, &user, 0});
+        }
+        market.submitBatch(orders, results);
+        if (replacements.empty()) return;
+        orders.clear();
+        for (auto& replacement : replacements) {
+            // The same order can be picked twice in one burst, or be filled first, so some cancels miss
+            const BatchResult& cancel = results[replacement.first];
+            if (cancel.status != BatchResult::OK || cancel.filledQuantity == 0) continue;
+            replacement.second.quantity = cancel.filledQuantity;
+            orders.push_back(replacement.second);
+        }
+        market.submitBatch(orders, results);
+    }
+
+    static double percentile(vector<double>& values, double fraction) {
+        if (values.empty()) return 0;
+        size_t index = min(values.size() - 1, (size_t)(fraction * values.size()));
+        nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    // Sender thread body: claims schedule slots in order, waits for each intended time and sends it
+    void sendLoop(StockMarket& market, unsigned seed) {
+        mt19937_64 rng(seed);
+        vector<BatchOrder> orders;   // Reused across bursts so their buffers stay allocated
+        vector<BatchResult> results;
+        orders.reserve(config.batch);
+        results.resize(config.batch);
+        for (size_t i = nextEvent++; i < arrivals.size(); i = nextEvent++) {
+            Clock::time_point intended = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(arrivals[i]));
+            if (Clock::now() < intended) this_thread::sleep_until(intended);
+            if (config.batch > 1) {
+                sendBurst(market, rng, orders, results);
+            } else {
+                sendEvent(market, rng);
+            }
+            completions[i] = chrono::duration<double>(Clock::now() - start).count();
+            ++finished;
+        }
+    }
+
+public:
+    LoadGenerator(const LoadConfig& cfg) : config(cfg), scheduleRng(cfg.seed), nextEvent(0), finished(0) {}
+
+    // Function to sign up the accounts and list the symbols used by the run
+    void setUp(UserManager& userManager, StockMarket& market) {
+        for (int i = 0; i < config.symbols; ++i) {
+            symbols.push_back("SYM" + to_string(i));
+            market.listStock(symbols.back(), true);
+            zipfCdf.push_back((zipfCdf.empty() ? 0 : zipfCdf.back()) + 1.0 / pow(i + 1, config.zipfExponent));
+        }
+        for (int i = 0; i < config.users; ++i) {
+            string username = "loaduser" + to_string(i);
+            userManager.signUp(username, true);
+            accounts.push_back(userManager.login(username));
+        }
+    }
+
+    // Function to run the open-loop schedule and print throughput, backlog and latency
+    void run(StockMarket& market) {
+        arrivals = scheduleArrivals();
+        completions.assign(arrivals.size(), 0);
+        nextEvent = 0;
+        finished = 0;
+
+        cout << "Load: " << config.users << " users, " << config.symbols << " symbols, " << config.arrivals
+             << " arrivals at " << config.rate << "/s for " << config.seconds << "s (" << arrivals.size()
+             << " events, " << config.threads << " sender threads)" << endl;
+        if (config.batch > 1) {
+            cout << "Each event is a burst of " << config.batch << " orders from one account sent through submitBatch" << endl;
+        }
+
+        start = Clock::now();
+        vector<thread> senders;
+        for (int t = 0; t < config.threads; ++t) {
+            senders.emplace_back(&LoadGenerator::sendLoop, this, ref(market), config.seed + 1 + t);
+        }
+
+        // Live progress while the senders run; the exact per-interval table is replayed once they finish
+        cout << "   time(s)   sent   backlog   (live)" << endl;
+        size_t finishedAtLastRow = 0;
+        double nextRow = config.reportInterval;
+        while (finished < arrivals.size()) {
+            Clock::time_point rowTime = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(nextRow));
+            this_thread::sleep_until(min(rowTime, Clock::now() + chrono::milliseconds(50)));
+            if (Clock::now() < rowTime) continue;
+            size_t sent = finished;
+            double elapsed = chrono::duration<double>(Clock::now() - start).count();
+            size_t due = upper_bound(arrivals.begin(), arrivals.end(), elapsed) - arrivals.begin();
+            cout << setw(10) << fixed << setprecision(2) << elapsed
+                 << setw(7) << sent - finishedAtLastRow
+                 << setw(10) << (due > sent ? due - sent : 0) << endl;
+            cout.unsetf(ios::floatfield);
+            finishedAtLastRow = sent;
+            while (nextRow <= elapsed) nextRow += config.reportInterval;
+        }
+        for (auto& sender : senders) {
+            sender.join();
+        }
+        double total = chrono::duration<double>(Clock::now() - start).count();
+
+        // Replay completions in time order to report each interval
+        vector<size_t> order(arrivals.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) { return completions[a] < completions[b]; });
+        vector<double> latencies, intervalLatencies; // Microseconds
+        latencies.reserve(arrivals.size());
+        cout << "Per-interval results:" << endl;
+        cout << "   time(s)   sent   rate(/s)   backlog   p99(us)" << endl;
+        size_t done = 0;
+        for (double from = 0, to; from < total; from = to) {
+            // A sliver left at the end is folded into the last row rather than reported on its own
+            to = from + config.reportInterval;
+            if (total - to < config.reportInterval * 0.1) to = total;
+            intervalLatencies.clear();
+            while (done < order.size() && completions[order[done]] <= to) {
+                size_t i = order[done++];
+                double latency = (completions[i] - arrivals[i]) * 1e6;
+                latencies.push_back(latency);
+                intervalLatencies.push_back(latency);
+            }
+            size_t due = upper_bound(arrivals.begin(), arrivals.end(), to) - arrivals.begin();
+            cout << setw(10) << fixed << setprecision(2) << to
+                 << setw(7) << intervalLatencies.size()
+                 << setw(11) << setprecision(0) << intervalLatencies.size() / (to - from)
+                 << setw(10) << due - done
+                 << setw(10) << percentile(intervalLatencies, 0.99) << endl;
+        }
+        cout << setprecision(1) << "Achieved " << arrivals.size() / total << " events/s over " << total << "s" << endl;
+        cout << "Latency (us) p50 " << percentile(latencies, 0.5) << "  p90 " << percentile(latencies, 0.9)
+             << "  p99 " << percentile(latencies, 0.99) << "  p99.9 " << percentile(latencies, 0.999)
+             << "  max " << percentile(latencies, 1.0) << endl;
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
+    }
+};
+
+// Reads a numeric option value; returns false unless the whole value is a finite number
+bool parseNumber(const string& value, double& number) {
+    size_t used = 0;
+    try {
+        number = stod(value, &used);
+    } catch (const exception&) {
+        return false;
+    }
+    return used == value.size() && isfinite(number);
+}
+
+// Parses "key=value" arguments that follow --load into config; prints the problem and returns false on a bad value
+bool parseLoadConfig(int argc, char* argv[], LoadConfig& config) {
+    bool intervalGiven = false;
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        string key = arg.substr(0, eq);
+        string value = eq == string::npos ? "" : arg.substr(eq + 1);
+        if (key == "arrivals") {
+            if (value != "poisson" && value != "hawkes") {
+                cout << "Invalid load option " << arg << ": arrivals must be poisson or hawkes." << endl;
+                return false;
+            }
+            config.arrivals = value;
+            continue;
+        }
+        static const set<string> numericKeys = {"users", "symbols", "threads", "batch", "rate", "seconds", "decay", "interval",
+                                                "branching", "zipf", "cancel", "replace", "seed"};
+        if (numericKeys.find(key) == numericKeys.end()) {
+            cout << "Ignoring unknown load option: " << arg << endl;
+            continue;
+        }
+        double number;
+        string rule;
+        if (!parseNumber(value, number)) {
+            rule = "value is not a number";
+        } else if (key == "batch") {
+            if (number < 1 || number > 10000 || number != floor(number)) rule = "must be a whole number from 1 to 10000";
+            else config.batch = (int)number;
+        } else if (key == "threads") {
+            if (number < 1 || number > 1024 || number != floor(number)) rule = "must be a whole number from 1 to 1024";
+            else config.threads = (int)number;
+        } else if (key == "users" || key == "symbols") {
+            if (number < 1 || number > 1000000 || number != floor(number)) rule = "must be a whole number from 1 to 1000000";
+            else if (key == "users") config.users = (int)number;
+            else config.symbols = (int)number;
+        } else if (key == "interval") {
+            if (number < 0.001) rule = "must be at least 0.001 seconds";
+            else config.reportInterval = number;
+            intervalGiven = true;
+        } else if (key == "rate" || key == "seconds" || key == "decay") {
+            if (number <= 0) rule = "must be greater than 0";
+            else if (key == "rate") config.rate = number;
+            else if (key == "seconds") config.seconds = number;
+            else config.hawkesDecay = number;
+        } else if (key == "branching") {
+            if (number < 0 || number >= 1) rule = "must be at least 0 and below 1 for a stable rate";
+            else config.hawkesBranching = number;
+        } else if (key == "zipf") {
+            if (number < 0) rule = "must not be negative";
+            else config.zipfExponent = number;
+        } else if (key == "cancel" || key == "replace") {
+            if (number < 0 || number > 1) rule = "must be between 0 and 1";
+            else if (key == "cancel") config.cancelRatio = number;
+            else config.replaceRatio = number;
+        } else {
+            if (number < 0 || number > UINT_MAX || number != floor(number)) rule = "must be a non-negative whole number";
+            else config.seed = (unsigned)number;
+        }
+        if (!rule.empty()) {
+            cout << "Invalid load option " << arg << ": " << rule << "." << endl;
+            return false;
+        }
+    }
+    if (config.cancelRatio + config.replaceRatio > 1) {
+        cout << "Invalid load options: cancel + replace must not exceed 1." << endl;
+        return false;
+    }
+    if (config.reportInterval > config.seconds) {
+        if (intervalGiven) {
+            cout << "Invalid load options: interval must not exceed seconds." << endl;
+            return false;
+        }
+        config.reportInterval = config.seconds; // Default interval on a run shorter than it
+    }
+    if (config.rate * config.seconds > 50000000) {
+        cout << "Invalid load options: rate * seconds must not exceed 50000000 events." << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
     UserManager userManager;
     StockMarket market;
     Management management;
 
+    // Non-interactive load test: ./order_book_multithreaded --load users=1000 symbols=24 rate=5000 ...
+    if (argc > 1 && string(argv[1]) == "--load") {
+        LoadConfig config;
+        if (!parseLoadConfig(argc, argv, config)) {
+            return 1;
+        }
+        LoadGenerator generator(config);
+        generator.setUp(userManager, market);
+        generator.run(market);
+        market.displayExposureSummary(5);
+        return 0;
+    }
+
     while (true) {
         cout << "Welcome to the Trading System!" << endl;
         cout << "1. Sign Up" << endl;
@@ -288,7 +1061,7 @@ int main() {
             string username;
             cout << "Enter username: ";
             cin >> username;
-            async(launch::async, &UserManager::signUp, &userManager, username).get();
+            async(launch::async, &UserManager::signUp, &userManager, username, false).get();
         } else if (choice == 2) {
             string username;
             cout << "Enter username: ";
@@ -357,6 +1130,7 @@ int main() {
             cin >> password;
             if (management.login(username, password)) {
                 cout << "Management login successful!" << endl;
+                market.displayExposureSummary(5);
                 management.listStock(market);
             } else {
                 cout << "Invalid credentials! Access denied." << endl;